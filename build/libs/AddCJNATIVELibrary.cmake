@@ -366,8 +366,9 @@ install(TARGETS stdx.net.tls.common DESTINATION ${output_triple_name}_${CJNATIVE
 
 make_cangjie_lib(
     net.http IS_SHARED
-    DEPENDS cangjie${BACKEND_TYPE}Http cangjie-dynamicLoader-opensslFFI-shared
+    DEPENDS cangjie${BACKEND_TYPE}Http cangjie-dynamicLoader-opensslFFI-shared stdx.net.httpFFI
     CANGJIE_STDX_LIB_DEPENDS
+        compress.zlib
         encoding.base64
         encoding.url
         log
@@ -394,12 +395,17 @@ make_cangjie_lib(
         std-env
     OBJECTS ${output_cj_object_dir}/stdx/net.http.o
     FLAGS
+    -lstdx.net.httpFFI
     ${openssl_flags}
     $<$<BOOL:${MINGW}>:-lws2_32>
     $<$<NOT:$<BOOL:${WIN32}>>:-ldl>)
 get_target_property(HTTPOPENSSLFFI_OBJS cangjie-dynamicLoader-opensslFFI SOURCES)
-add_library(stdx.net.http STATIC ${HTTPOPENSSLFFI_OBJS} ${output_cj_object_dir}/stdx/net.http.o)
+add_library(stdx.net.http STATIC
+    $<TARGET_OBJECTS:stdx.net.httpFFI-objs>
+    ${HTTPOPENSSLFFI_OBJS}
+    ${output_cj_object_dir}/stdx/net.http.o)
 add_library(stdx.net.http-strong STATIC
+    $<TARGET_OBJECTS:stdx.net.httpFFI-objs>
     $<TARGET_OBJECTS:${CANGJIE_OPENSSL_FFI_STRONG_OBJECTS_TARGET}>
     ${output_cj_object_dir}/stdx/net.http.o)
 set_target_properties(stdx.net.http PROPERTIES LINKER_LANGUAGE C)
@@ -55,6 +55,7 @@ set(NET_TLS_COMMON_DEPENDENCIES
     cangjie${BACKEND_TYPE}CryptoCommon)
 
 set(NET_HTTP_DEPENDENCIES
+    cangjie${BACKEND_TYPE}ZLIB
     cangjie${BACKEND_TYPE}Base64
     cangjie${BACKEND_TYPE}Url
     cangjie${BACKEND_TYPE}Log
@@ -55,6 +55,7 @@ set(NET_TLS_COMMON_DEPENDENCIES
     cangjie${BACKEND_TYPE}CryptoCommon_bc)
 
 set(NET_HTTP_DEPENDENCIES
+    cangjie${BACKEND_TYPE}ZLIB_bc
     cangjie${BACKEND_TYPE}Base64_bc
     cangjie${BACKEND_TYPE}Url_bc
     cangjie${BACKEND_TYPE}Log_bc
@@ -57,6 +57,11 @@ extern int CJ_ZlibStreamEncode(z_stream* zlibStream, int flushType)
     return deflate(zlibStream, flushType);
 }
 
+extern int CJ_ZlibStreamEncodeReset(z_stream* zlibStream)
+{
+    return deflateReset(zlibStream);
+}
+
 extern int CJ_ZlibStreamEncodeFini(z_stream* zlibStream)
 {
     return deflateEnd(zlibStream);
@@ -72,6 +77,11 @@ extern int CJ_ZlibStreamDecode(z_stream* zlibStream, int flushType)
     return inflate(zlibStream, flushType);
 }
 
+extern int CJ_ZlibStreamDecodeReset(z_stream* zlibStream)
+{
+    return inflateReset(zlibStream);
+}
+
 extern int CJ_ZlibStreamDecodeFini(z_stream* zlibStream)
 {
     return inflateEnd(zlibStream);
@@ -278,56 +278,48 @@ static void GetExtensionResultFromName(GENERAL_NAMES* subjectAltNames, int type,
     }
 }
 
-static void GetX509ExtensionByNameType(
-    const unsigned char* derBlob, size_t length, void* result, int type, DynMsg* dynMsg)
+static void GetX509ExtensionByNameType(X509* cert, void* result, int type, DynMsg* dynMsg)
 {
     if (memset_s(result, X509_RESULT_SIZE, 0, X509_RESULT_SIZE) != 0) {
         return;
     }
 
-    X509* cert = DYN_d2i_X509(NULL, &derBlob, (long)length, dynMsg);
     if (cert == NULL) {
         return;
     }
     GENERAL_NAMES* subjectAltNames =
         (GENERAL_NAMES*)DYN_X509_get_ext_d2i(cert, NID_subject_alt_name, NULL, NULL, dynMsg);
     if (dynMsg && dynMsg->found == false) {
-        DYN_X509_free(cert, dynMsg);
         return;
     }
     GetExtensionResultFromName(subjectAltNames, type, result, dynMsg);
     if (subjectAltNames != NULL) {
         DynPopFree(subjectAltNames, "GENERAL_NAME_free", dynMsg);
     }
-    DYN_X509_free(cert, dynMsg);
 }
 
-// Get DNS names in X509 extension.
-extern void DYN_CJGetX509DnsNames(
-    const unsigned char* derBlob, size_t length, struct ByteArrayResult* result, DynMsg* dynMsg)
+// Get DNS names in X509 extension, cert is parsed by DYN_CJX509CertParse.
+extern void DYN_CJGetX509DnsNames(void* cert, struct ByteArrayResult* result, DynMsg* dynMsg)
 {
-    GetX509ExtensionByNameType(derBlob, length, result, GEN_DNS, dynMsg);
+    GetX509ExtensionByNameType((X509*)cert, result, GEN_DNS, dynMsg);
 }
 
-// Get email addresses in X509 extension.
-extern void DYN_CJGetX509EmailAddresses(
-    const unsigned char* derBlob, size_t length, struct ByteArrayResult* result, DynMsg* dynMsg)
+// Get email addresses in X509 extension, cert is parsed by DYN_CJX509CertParse.
+extern void DYN_CJGetX509EmailAddresses(void* cert, struct ByteArrayResult* result, DynMsg* dynMsg)
 {
-    GetX509ExtensionByNameType(derBlob, length, result, GEN_EMAIL, dynMsg);
+    GetX509ExtensionByNameType((X509*)cert, result, GEN_EMAIL, dynMsg);
 }
 
-// Get IP addresses in X509 extension.
-extern void DYN_CJGetX509IpAddresses(
-    const unsigned char* derBlob, size_t length, struct ByteArrayResult* result, DynMsg* dynMsg)
+// Get IP addresses in X509 extension, cert is parsed by DYN_CJX509CertParse.
+extern void DYN_CJGetX509IpAddresses(void* cert, struct ByteArrayResult* result, DynMsg* dynMsg)
 {
-    GetX509ExtensionByNameType(derBlob, length, result, GEN_IPADD, dynMsg);
+    GetX509ExtensionByNameType((X509*)cert, result, GEN_IPADD, dynMsg);
 }
 
-// Get key usage in X509 extension.
-extern uint16_t DYN_CJGetX509KeyUsage(const unsigned char* derBlob, size_t length, DynMsg* dynMsg)
+// Get key usage in X509 extension, cert is parsed by DYN_CJX509CertParse.
+extern uint16_t DYN_CJGetX509KeyUsage(void* cert, DynMsg* dynMsg)
 {
     uint16_t keyUsage = 0;
-    X509* cert = DYN_d2i_X509(NULL, &derBlob, (long)length, dynMsg);
     if (cert == NULL) {
         return keyUsage;
     }
@@ -342,7 +334,6 @@ extern uint16_t DYN_CJGetX509KeyUsage(const unsigned char* derBlob, size_t lengt
         }
         DYN_ASN1_BIT_STRING_free(usage, dynMsg);
     }
-    DYN_X509_free(cert, dynMsg);
     // Process the KU_DECIPHER_ONLY  -> 0x01xx for cangjie.
     if ((keyUsage & (uint16_t)(KU_DECIPHER_ONLY)) != 0) {
         const uint16_t setMask = 0x0100;
@@ -402,27 +393,23 @@ static void StoreExtKeyUsageResult(EXTENDED_KEY_USAGE* extusage, struct UInt16Re
     }
 }
 
-// Get ext key usage in X509 extension.
-extern void DYN_CJGetX509ExtKeyUsage(
-    const unsigned char* derBlob, size_t length, struct UInt16Result* result, DynMsg* dynMsg)
+// Get ext key usage in X509 extension, cert is parsed by DYN_CJX509CertParse.
+extern void DYN_CJGetX509ExtKeyUsage(void* cert, struct UInt16Result* result, DynMsg* dynMsg)
 {
     result->size = 0;
     result->buffer = NULL;
-    X509* cert = DYN_d2i_X509(NULL, &derBlob, (long)length, dynMsg);
     if (cert == NULL) {
         return;
     }
     EXTENDED_KEY_USAGE* extusage = NULL;
-    extusage = DYN_X509_get_ext_d2i(cert, NID_ext_key_usage, NULL, NULL, dynMsg);
+    extusage = DYN_X509_get_ext_d2i((X509*)cert, NID_ext_key_usage, NULL, NULL, dynMsg);
     if (dynMsg && dynMsg->found == false) {
-        DYN_X509_free(cert, dynMsg);
         return;
     }
     StoreExtKeyUsageResult(extusage, result, dynMsg);
     if (extusage != NULL) {
         DYN_OPENSSL_sk_free((void*)extusage, dynMsg);
     }
-    DYN_X509_free(cert, dynMsg);
 }
 
 static int X509StoreRawCert(X509_STORE* chains, const unsigned char** raw, size_t size, DynMsg* dynMsg)
@@ -437,6 +424,45 @@ static int X509StoreRawCert(X509_STORE* chains, const unsigned char** raw, size_
     return status;
 }
 
+static X509_STORE* X509StoreRawCerts(struct RawX509CertArray* rawRoots, DynMsg* dynMsg)
+{
+    X509_STORE* chains = DYN_X509_STORE_new(dynMsg);
+    if (chains == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < rawRoots->size; i++) {
+        if (X509StoreRawCert(chains, &rawRoots->buffer[i].content, rawRoots->buffer[i].size, dynMsg) != 1) {
+            DYN_X509_STORE_free(chains, dynMsg);
+            return NULL;
+        }
+    }
+    return chains;
+}
+
+// Verify cert with ctx, which is cleaned up afterwards so that it can be reused.
+static int X509VerifyWithCtx(
+    X509_STORE_CTX* ctx, X509* cert, X509_STORE* chains, STACK_OF(X509) * untrustedChain, DynMsg* dynMsg)
+{
+    int status = -1;
+    if (DYN_X509_STORE_CTX_init(ctx, chains, cert, untrustedChain, dynMsg) == 1) {
+        status = DYN_X509_verify_cert(ctx, dynMsg);
+    }
+    DYN_X509_STORE_CTX_cleanup(ctx, dynMsg);
+    return status;
+}
+
+// Verify cert against the trust anchors in chains, the untrusted chain may be NULL.
+static int X509VerifyWithStore(X509* cert, X509_STORE* chains, STACK_OF(X509) * untrustedChain, DynMsg* dynMsg)
+{
+    X509_STORE_CTX* ctx = DYN_X509_STORE_CTX_new(dynMsg);
+    if (ctx == NULL) {
+        return -1;
+    }
+    int status = X509VerifyWithCtx(ctx, cert, chains, untrustedChain, dynMsg);
+    DYN_X509_STORE_CTX_free(ctx, dynMsg);
+    return status;
+}
+
 // Certificate Der Blob
 extern int DYN_CJVerifyX509Cert(struct RawX509Cert* rawCert, struct RawX509CertArray* rawRoots,
     struct RawX509CertArray* rawIntermediates, DynMsg* dynMsg)
@@ -448,19 +474,10 @@ extern int DYN_CJVerifyX509Cert(struct RawX509Cert* rawCert, struct RawX509CertA
     }
     int status = 0;
     // Create certificate store and add only root certificates as trust anchors
-    X509_STORE* chains = DYN_X509_STORE_new(dynMsg);
+    X509_STORE* chains = X509StoreRawCerts(rawRoots, dynMsg);
     if (chains == NULL) {
         status = -1;
     }
-    if (status != -1) {
-        // Add root certs as trust anchors
-        for (size_t i = 0; i < rawRoots->size; i++) {
-            if (X509StoreRawCert(chains, &rawRoots->buffer[i].content, rawRoots->buffer[i].size, dynMsg) != 1) {
-                status = -1;
-                break;
-            }
-        }
-    }
     // Build untrusted chain from intermediate certificates
     STACK_OF(X509) * untrustedChain = NULL;
     if (status != -1 && rawIntermediates->size > 0) {
@@ -483,33 +500,95 @@ extern int DYN_CJVerifyX509Cert(struct RawX509Cert* rawCert, struct RawX509CertA
             }
         }
     }
-    X509_STORE_CTX* ctx = NULL;
     if (status != -1) {
-        ctx = DYN_X509_STORE_CTX_new(dynMsg);
-        if (ctx == NULL) {
+        // Verify certificate
+        status = X509VerifyWithStore(cert, chains, untrustedChain, dynMsg);
+    }
+    // Clean up
+    if (untrustedChain != NULL) {
+        DynPopFree(untrustedChain, "X509_free", dynMsg);
+    }
+    if (chains != NULL) {
+        DYN_X509_STORE_free(chains, dynMsg);
+    }
+    DYN_X509_free(cert, dynMsg);
+    return status;
+}
+
+// Parse the roots once into a store that can be shared by verifications on different threads.
+extern void* DYN_CJX509StoreNew(struct RawX509CertArray* rawRoots, DynMsg* dynMsg)
+{
+    return X509StoreRawCerts(rawRoots, dynMsg);
+}
+
+extern void DYN_CJX509StoreFree(void* store, DynMsg* dynMsg)
+{
+    DYN_X509_STORE_free((X509_STORE*)store, dynMsg);
+}
+
+extern void* DYN_CJX509CertParse(struct RawX509Cert* rawCert, DynMsg* dynMsg)
+{
+    return DYN_d2i_X509(NULL, &rawCert->content, (long)rawCert->size, dynMsg);
+}
+
+extern int DYN_CJX509CertUpRef(void* cert, DynMsg* dynMsg)
+{
+    return DYN_X509_up_ref((X509*)cert, dynMsg);
+}
+
+extern void DYN_CJX509CertFree(void* cert, DynMsg* dynMsg)
+{
+    DYN_X509_free((X509*)cert, dynMsg);
+}
+
+extern void* DYN_CJX509StoreCtxNew(DynMsg* dynMsg)
+{
+    return DYN_X509_STORE_CTX_new(dynMsg);
+}
+
+extern void DYN_CJX509StoreCtxFree(void* ctx, DynMsg* dynMsg)
+{
+    DYN_X509_STORE_CTX_free((X509_STORE_CTX*)ctx, dynMsg);
+}
+
+/*
+ * Verify the cert against a store created by DYN_CJX509StoreNew.
+ * The intermediates are parsed certs, a reference of each is taken over by this call.
+ * ctx is created by DYN_CJX509StoreCtxNew to be reused by several verifications, or NULL.
+ */
+extern int DYN_CJVerifyX509CertWithStore(
+    struct RawX509Cert* rawCert, void* store, void** intermediates, size_t count, void* ctx, DynMsg* dynMsg)
+{
+    int status = 0;
+    STACK_OF(X509) * untrustedChain = NULL;
+    if (count > 0) {
+        untrustedChain = (STACK_OF(X509) *)DYN_OPENSSL_sk_new_null(dynMsg);
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (untrustedChain == NULL || status == -1 ||
+            DYN_OPENSSL_sk_push(untrustedChain, intermediates[i], dynMsg) <= 0) {
+            DYN_X509_free((X509*)intermediates[i], dynMsg);
             status = -1;
         }
     }
+    X509* cert = NULL;
     if (status != -1) {
-        if (DYN_X509_STORE_CTX_init(ctx, chains, cert, untrustedChain, dynMsg) != 1) {
+        cert = DYN_d2i_X509(NULL, &rawCert->content, (long)rawCert->size, dynMsg);
+        if (cert == NULL) {
             status = -1;
         }
     }
-    if (status != -1) {
-        // Verify certificate
-        status = DYN_X509_verify_cert(ctx, dynMsg);
-    }
-    // Clean up
-    if (ctx != NULL) {
-        DYN_X509_STORE_CTX_free(ctx, dynMsg);
+    if (status != -1 && ctx != NULL) {
+        status = X509VerifyWithCtx((X509_STORE_CTX*)ctx, cert, (X509_STORE*)store, untrustedChain, dynMsg);
+    } else if (status != -1) {
+        status = X509VerifyWithStore(cert, (X509_STORE*)store, untrustedChain, dynMsg);
     }
     if (untrustedChain != NULL) {
         DynPopFree(untrustedChain, "X509_free", dynMsg);
     }
-    if (chains != NULL) {
-        DYN_X509_STORE_free(chains, dynMsg);
+    if (cert != NULL) {
+        DYN_X509_free(cert, dynMsg);
     }
-    DYN_X509_free(cert, dynMsg);
     return status;
 }
 
@@ -955,11 +955,129 @@ BIO* DYN_BIO_new_mem(DynMsg* dynMsg)
     return func1(func2());
 }
 
+/*
+ * The functions of defineFunction.inc are resolved into one dense table indexed by OPENSSL_SYMBOL_<name>,
+ * so that CJ_OpenSSL_Preload() can resolve all of them in one pass and the DYN_* wrappers find them with a
+ * single load. Some names are macros of the headers, OPENSSL_SYMBOL_NAME expands them to the exported names.
+ */
+#define OPENSSL_SYMBOL_NAME(name) #name
+#define DEFINEFUNCTION0(name, errCode, type0) OPENSSL_SYMBOL_##name,
+#define DEFINEFUNCTION1(name, errCode, type0, type1) OPENSSL_SYMBOL_##name,
+#define DEFINEFUNCTION2(name, errCode, type0, type1, type2) OPENSSL_SYMBOL_##name,
+#define DEFINEFUNCTION3(name, errCode, type0, type1, type2, type3) OPENSSL_SYMBOL_##name,
+#define DEFINEFUNCTION4(name, errCode, type0, type1, type2, type3, type4) OPENSSL_SYMBOL_##name,
+#define DEFINEFUNCTION5(name, errCode, type0, type1, type2, type3, type4, type5) OPENSSL_SYMBOL_##name,
+#define DEFINEFUNCTION6(name, errCode, type0, type1, type2, type3, type4, type5, type6) OPENSSL_SYMBOL_##name,
+#define DEFINEFUNCTION7(name, errCode, type0, type1, type2, type3, type4, type5, type6, type7) OPENSSL_SYMBOL_##name,
+#define DEFINEFUNCTION8(name, errCode, type0, type1, type2, type3, type4, type5, type6, type7, type8) OPENSSL_SYMBOL_##name,
+#define DEFINEFUNCTIONCB2(name, errCode, type0, type1, type2) OPENSSL_SYMBOL_##name,
+#define DEFINEFUNCTIONCB3(name, errCode, type0, type1, type2, type3) OPENSSL_SYMBOL_##name,
+enum OpenSslSymbol {
+#include "defineFunction.inc"
+    OPENSSL_SYMBOL_COUNT
+};
+#undef DEFINEFUNCTION0
+#undef DEFINEFUNCTION1
+#undef DEFINEFUNCTION2
+#undef DEFINEFUNCTION3
+#undef DEFINEFUNCTION4
+#undef DEFINEFUNCTION5
+#undef DEFINEFUNCTION6
+#undef DEFINEFUNCTION7
+#undef DEFINEFUNCTION8
+#undef DEFINEFUNCTIONCB2
+#undef DEFINEFUNCTIONCB3
+#undef DEFINEFUNCTION
+
+#define DEFINEFUNCTION0(name, errCode, type0) OPENSSL_SYMBOL_NAME(name),
+#define DEFINEFUNCTION1(name, errCode, type0, type1) OPENSSL_SYMBOL_NAME(name),
+#define DEFINEFUNCTION2(name, errCode, type0, type1, type2) OPENSSL_SYMBOL_NAME(name),
+#define DEFINEFUNCTION3(name, errCode, type0, type1, type2, type3) OPENSSL_SYMBOL_NAME(name),
+#define DEFINEFUNCTION4(name, errCode, type0, type1, type2, type3, type4) OPENSSL_SYMBOL_NAME(name),
+#define DEFINEFUNCTION5(name, errCode, type0, type1, type2, type3, type4, type5) OPENSSL_SYMBOL_NAME(name),
+#define DEFINEFUNCTION6(name, errCode, type0, type1, type2, type3, type4, type5, type6) OPENSSL_SYMBOL_NAME(name),
+#define DEFINEFUNCTION7(name, errCode, type0, type1, type2, type3, type4, type5, type6, type7) OPENSSL_SYMBOL_NAME(name),
+#define DEFINEFUNCTION8(name, errCode, type0, type1, type2, type3, type4, type5, type6, type7, type8) OPENSSL_SYMBOL_NAME(name),
+#define DEFINEFUNCTIONCB2(name, errCode, type0, type1, type2) OPENSSL_SYMBOL_NAME(name),
+#define DEFINEFUNCTIONCB3(name, errCode, type0, type1, type2, type3) OPENSSL_SYMBOL_NAME(name),
+static const char* const g_opensslSymbolNames[OPENSSL_SYMBOL_COUNT] = {
+#include "defineFunction.inc"
+};
+#undef DEFINEFUNCTION0
+#undef DEFINEFUNCTION1
+#undef DEFINEFUNCTION2
+#undef DEFINEFUNCTION3
+#undef DEFINEFUNCTION4
+#undef DEFINEFUNCTION5
+#undef DEFINEFUNCTION6
+#undef DEFINEFUNCTION7
+#undef DEFINEFUNCTION8
+#undef DEFINEFUNCTIONCB2
+#undef DEFINEFUNCTIONCB3
+#undef DEFINEFUNCTION
+
+#if defined(CANGJIE_OPENSSL_RESOLVE_STRONG) || (defined(CANGJIE_OPENSSL_RESOLVE_AUTO) && CANGJIE_OPENSSL_AUTO_WEAK_AVAILABLE)
+/* Link-time addresses, NULL for the weak symbols that are not linked. */
+#define DEFINEFUNCTION0(name, errCode, type0) (void*)(name),
+#define DEFINEFUNCTION1(name, errCode, type0, type1) (void*)(name),
+#define DEFINEFUNCTION2(name, errCode, type0, type1, type2) (void*)(name),
+#define DEFINEFUNCTION3(name, errCode, type0, type1, type2, type3) (void*)(name),
+#define DEFINEFUNCTION4(name, errCode, type0, type1, type2, type3, type4) (void*)(name),
+#define DEFINEFUNCTION5(name, errCode, type0, type1, type2, type3, type4, type5) (void*)(name),
+#define DEFINEFUNCTION6(name, errCode, type0, type1, type2, type3, type4, type5, type6) (void*)(name),
+#define DEFINEFUNCTION7(name, errCode, type0, type1, type2, type3, type4, type5, type6, type7) (void*)(name),
+#define DEFINEFUNCTION8(name, errCode, type0, type1, type2, type3, type4, type5, type6, type7, type8) (void*)(name),
+#define DEFINEFUNCTIONCB2(name, errCode, type0, type1, type2) (void*)(name),
+#define DEFINEFUNCTIONCB3(name, errCode, type0, type1, type2, type3) (void*)(name),
+static void* const g_opensslLinkedSymbols[OPENSSL_SYMBOL_COUNT] = {
+#include "defineFunction.inc"
+};
+#undef DEFINEFUNCTION0
+#undef DEFINEFUNCTION1
+#undef DEFINEFUNCTION2
+#undef DEFINEFUNCTION3
+#undef DEFINEFUNCTION4
+#undef DEFINEFUNCTION5
+#undef DEFINEFUNCTION6
+#undef DEFINEFUNCTION7
+#undef DEFINEFUNCTION8
+#undef DEFINEFUNCTIONCB2
+#undef DEFINEFUNCTIONCB3
+#undef DEFINEFUNCTION
+#endif
+
+static _Atomic(uintptr_t) g_opensslSymbols[OPENSSL_SYMBOL_COUNT];
+
+static void* LoadOpenSslSymbol(size_t index)
+{
+    void* func = (void*)LoadCachedFunctionBits(&g_opensslSymbols[index]);
+    if (func != NULL) {
+        return func;
+    }
+#if defined(CANGJIE_OPENSSL_RESOLVE_STRONG) || (defined(CANGJIE_OPENSSL_RESOLVE_AUTO) && CANGJIE_OPENSSL_AUTO_WEAK_AVAILABLE)
+    func = g_opensslLinkedSymbols[index];
+#endif
+#ifndef CANGJIE_OPENSSL_RESOLVE_STRONG
+    if (func == NULL) {
+        func = FindFunction(g_opensslSymbolNames[index]);
+    }
+#endif
+    PublishCachedFunctionBits(&g_opensslSymbols[index], (uintptr_t)func);
+    return (void*)LoadCachedFunctionBits(&g_opensslSymbols[index]);
+}
+
+#define FINDTABLEFUNCTION(dynMsg, index, errCode)                                                                                                                                  \
+    SSLFunc func = (SSLFunc)LoadCachedFunctionBits(&g_opensslSymbols[index]);                                                                                                      \
+    if (func == NULL) {                                                                                                                                                            \
+        func = (SSLFunc)LoadOpenSslSymbol(index);                                                                                                                                  \
+    }                                                                                                                                                                              \
+    CHECKFUNCTION(dynMsg, , g_opensslSymbolNames[index], errCode)
+
 #define DEFINEFUNCTION0(name, errCode, type0)                                                                                                                                      \
     type0 DYN_##name(DynMsg* dynMsg)                                                                                                                                               \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(void);                                                                                                                                            \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func();                                                                                                                                                             \
     }
 
@@ -967,7 +1085,7 @@ BIO* DYN_BIO_new_mem(DynMsg* dynMsg)
     type0 DYN_##name(type1 arg1, DynMsg* dynMsg)                                                                                                                                   \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(type1);                                                                                                                                           \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func(arg1);                                                                                                                                                         \
     }
 
@@ -975,63 +1093,63 @@ BIO* DYN_BIO_new_mem(DynMsg* dynMsg)
     type0 DYN_##name(type1 arg1, type2 arg2, DynMsg* dynMsg)                                                                                                                       \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(type1, type2);                                                                                                                                    \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func(arg1, arg2);                                                                                                                                                   \
     }
 #define DEFINEFUNCTIONCB2(name, errCode, type0, type1, type2)                                                                                                                      \
     type0 DYN_##name(type1, type2, DynMsg* dynMsg)                                                                                                                                 \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(type1, type2);                                                                                                                                    \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func(arg1, arg2);                                                                                                                                                   \
     }
 #define DEFINEFUNCTION3(name, errCode, type0, type1, type2, type3)                                                                                                                 \
     type0 DYN_##name(type1 arg1, type2 arg2, type3 arg3, DynMsg* dynMsg)                                                                                                           \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(type1, type2, type3);                                                                                                                             \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func(arg1, arg2, arg3);                                                                                                                                             \
     }
 #define DEFINEFUNCTIONCB3(name, errCode, type0, type1, type2, type3)                                                                                                               \
     type0 DYN_##name(type1, type2, type3, DynMsg* dynMsg)                                                                                                                          \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(type1, type2, type3);                                                                                                                             \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func(arg1, arg2, arg3);                                                                                                                                             \
     }
 #define DEFINEFUNCTION4(name, errCode, type0, type1, type2, type3, type4)                                                                                                          \
     type0 DYN_##name(type1 arg1, type2 arg2, type3 arg3, type4 arg4, DynMsg* dynMsg)                                                                                               \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(type1, type2, type3, type4);                                                                                                                      \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func(arg1, arg2, arg3, arg4);                                                                                                                                       \
     }
 #define DEFINEFUNCTION5(name, errCode, type0, type1, type2, type3, type4, type5)                                                                                                   \
     type0 DYN_##name(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, DynMsg* dynMsg)                                                                                   \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(type1, type2, type3, type4, type5);                                                                                                               \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func(arg1, arg2, arg3, arg4, arg5);                                                                                                                                 \
     }
 #define DEFINEFUNCTION6(name, errCode, type0, type1, type2, type3, type4, type5, type6)                                                                                            \
     type0 DYN_##name(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, DynMsg* dynMsg)                                                                       \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(type1, type2, type3, type4, type5, type6);                                                                                                        \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func(arg1, arg2, arg3, arg4, arg5, arg6);                                                                                                                           \
     }
 #define DEFINEFUNCTION7(name, errCode, type0, type1, type2, type3, type4, type5, type6, type7)                                                                                     \
     type0 DYN_##name(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7, DynMsg* dynMsg)                                                           \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(type1, type2, type3, type4, type5, type6, type7);                                                                                                 \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func(arg1, arg2, arg3, arg4, arg5, arg6, arg7);                                                                                                                     \
     }
 #define DEFINEFUNCTION8(name, errCode, type0, type1, type2, type3, type4, type5, type6, type7, type8)                                                                              \
     type0 DYN_##name(type1 arg1, type2 arg2, type3 arg3, type4 arg4, type5 arg5, type6 arg6, type7 arg7, type8 arg8, DynMsg* dynMsg)                                               \
     {                                                                                                                                                                              \
         typedef type0 (*SSLFunc)(type1, type2, type3, type4, type5, type6, type7, type8);                                                                                          \
-        FINDFUNCTION(dynMsg, name, errCode)                                                                                                                                        \
+        FINDTABLEFUNCTION(dynMsg, OPENSSL_SYMBOL_##name, errCode)                                                                                                                  \
         return func(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8);                                                                                                               \
     }
 #include "defineFunction.inc"
@@ -1047,6 +1165,24 @@ BIO* DYN_BIO_new_mem(DynMsg* dynMsg)
 #undef DEFINEFUNCTIONCB2
 #undef DEFINEFUNCTIONCB3
 
+int CJ_OpenSSL_Preload(const char** missing, int capacity)
+{
+    int count = 0;
+    for (size_t i = 0; i < OPENSSL_SYMBOL_COUNT; i++) {
+        if (LoadOpenSslSymbol(i) != NULL) {
+            continue;
+        }
+        if (missing != NULL && count < capacity) {
+            missing[count] = g_opensslSymbolNames[i];
+        }
+        count++;
+    }
+    if (count == OPENSSL_SYMBOL_COUNT) {
+        return -1;
+    }
+    return count;
+}
+
 bool LoadDynFuncForAlpnCallback(DynMsg* dynMsg)
 {
     typedef SSL_CTX* (*SSLFunc0)(const SSL*);
@@ -1186,3 +1322,26 @@ void DynPopFree(void* extlist, const char* funcName, DynMsg* dynMsg)
 #endif
     DYN_OPENSSL_sk_pop_free(extlist, func0, dynMsg);
 }
+
+static volatile int64_t g_forkGeneration = 0;
+#ifndef _WIN32
+static pthread_once_t g_forkHandlerOnce = PTHREAD_ONCE_INIT;
+
+static void IncreaseForkGeneration(void)
+{
+    g_forkGeneration++;
+}
+
+static void RegisterForkHandler(void)
+{
+    (void)pthread_atfork(NULL, NULL, IncreaseForkGeneration);
+}
+#endif
+
+const volatile int64_t* CJ_ForkGeneration(void)
+{
+#ifndef _WIN32
+    (void)pthread_once(&g_forkHandlerOnce, RegisterForkHandler);
+#endif
+    return &g_forkGeneration;
+}
@@ -22,6 +22,7 @@
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 #ifndef OPENSSL_VERSION
@@ -54,8 +55,9 @@
  * Dynamic message structure for tracking function resolution status.
  *
  * Lifecycle:
- * - Callers must allocate using MallocDynMsg() before use.
- * - Callers must free using FreeDynMsg() after use.
+ * - Callers should keep the struct on their own stack, initialized with found = true and funcName = NULL,
+ *   and pass its address; MallocDynMsg()/FreeDynMsg() are kept for callers that need a heap copy.
+ * - It is only written when a function fails to resolve, so a call that succeeds costs no allocation.
  * - The funcName pointer is managed internally and valid for the struct's lifetime.
  */
 typedef struct DynMsg {
@@ -67,6 +69,25 @@ DynMsg* MallocDynMsg(void);
 void FreeDynMsg(DynMsg* dynMsgPtr);
 int CJ_OpenSSL_SetPath(const char* cryptoPath, const char* sslPath);
 
+/**
+ * Resolve every function of defineFunction.inc now instead of on first use.
+ *
+ * @param missing Receives the names of the functions that can not be resolved, up to capacity of them.
+ *                The names have static storage duration. May be NULL.
+ * @param capacity Number of entries of missing
+ * @return The number of functions that can not be resolved, or -1 if none can be resolved,
+ *         that is, the OpenSSL libraries can not be loaded.
+ */
+int CJ_OpenSSL_Preload(const char** missing, int capacity);
+
+/**
+ * A counter incremented in the child process by every fork, so that buffers of random bytes
+ * can notice a fork with a memory read instead of a getpid call per draw.
+ *
+ * @return The address of the counter, valid for the lifetime of the process.
+ */
+const volatile int64_t* CJ_ForkGeneration(void);
+
 char* DYN_OPENSSL_strdup(const char* str, DynMsg* dynMsg);
 char* DYN_OPENSSL_strndup(const char* str, size_t s, DynMsg* dynMsg);
 void* DYN_OPENSSL_memdup(void* str, size_t s, DynMsg* dynMsg);
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ * This source file is part of the Cangjie project, licensed under Apache-2.0
+ * with Runtime Library Exception.
+ *
+ * See https://cangjie-lang.cn/pages/LICENSE for license information.
+ */
+
+#include <string.h>
+#include "websocket_mask.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define WS_MASK_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define WS_MASK_NEON 1
+#endif
+
+#define MASK_KEY_LEN 4
+
+static inline uint8_t KeyByte(uint32_t maskingKey, int64_t index)
+{
+    return (uint8_t)(maskingKey >> (8 * (index % MASK_KEY_LEN)));
+}
+
+/* key rotated so that its first byte applies to the byte at the given phase, replicated to 64 bits */
+static uint64_t ReplicateKey(uint32_t maskingKey, int64_t phase)
+{
+    uint8_t rotated[8];
+    for (int i = 0; i < 8; i++) {
+        rotated[i] = KeyByte(maskingKey, phase + i);
+    }
+    uint64_t key;
+    (void)memcpy(&key, rotated, sizeof(key));
+    return key;
+}
+
+static int64_t MaskWords(uint8_t* data, int64_t len, uint64_t key)
+{
+    int64_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t word;
+        (void)memcpy(&word, data + i, sizeof(word));
+        word ^= key;
+        (void)memcpy(data + i, &word, sizeof(word));
+    }
+    return i;
+}
+
+#if defined(WS_MASK_X86)
+__attribute__((target("avx2"))) static int64_t MaskAvx2(uint8_t* data, int64_t len, uint64_t key)
+{
+    __m256i k = _mm256_set1_epi64x((long long)key);
+    int64_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        _mm256_storeu_si256((__m256i*)(data + i), _mm256_xor_si256(v, k));
+    }
+    return i;
+}
+
+static int64_t MaskSse2(uint8_t* data, int64_t len, uint64_t key)
+{
+    __m128i k = _mm_set1_epi64x((long long)key);
+    int64_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        _mm_storeu_si128((__m128i*)(data + i), _mm_xor_si128(v, k));
+    }
+    return i;
+}
+
+static int HasAvx2(void)
+{
+    static int hasAvx2 = -1;
+    if (hasAvx2 < 0) {
+        __builtin_cpu_init();
+        hasAvx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return hasAvx2;
+}
+#elif defined(WS_MASK_NEON)
+static int64_t MaskNeon(uint8_t* data, int64_t len, uint64_t key)
+{
+    uint8x16_t k = vreinterpretq_u8_u64(vdupq_n_u64(key));
+    int64_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        vst1q_u8(data + i, veorq_u8(vld1q_u8(data + i), k));
+    }
+    return i;
+}
+#endif
+
+int64_t CJ_HTTP_WebSocketMask(uint8_t* data, int64_t len, uint32_t maskingKey, int64_t phase)
+{
+    if (data == NULL || len <= 0) {
+        return phase;
+    }
+    phase %= MASK_KEY_LEN;
+    /* every step below is a multiple of 4 bytes, so the key keeps its phase */
+    uint64_t key = ReplicateKey(maskingKey, phase);
+    int64_t done = 0;
+#if defined(WS_MASK_X86)
+    if (HasAvx2()) {
+        done = MaskAvx2(data, len, key);
+    }
+    done += MaskSse2(data + done, len - done, key);
+#elif defined(WS_MASK_NEON)
+    done = MaskNeon(data, len, key);
+#endif
+    done += MaskWords(data + done, len - done, key);
+    for (; done < len; done++) {
+        data[done] ^= KeyByte(maskingKey, phase + done);
+    }
+    return (phase + len) % MASK_KEY_LEN;
+}
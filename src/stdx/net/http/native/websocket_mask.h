@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+ * This source file is part of the Cangjie project, licensed under Apache-2.0
+ * with Runtime Library Exception.
+ *
+ * See https://cangjie-lang.cn/pages/LICENSE for license information.
+ */
+
+#ifndef WEBSOCKET_MASK_H
+#define WEBSOCKET_MASK_H
+
+#include <stdint.h>
+
+/*
+ * XOR len bytes of data in place with the 4-byte masking key (RFC 6455 5.3),
+ * maskingKey holds key octet j in bits 8 * j .. 8 * j + 7.
+ * phase is the offset of data[0] in the payload modulo 4, the phase following data is returned,
+ * so a payload can be masked across several calls.
+ */
+int64_t CJ_HTTP_WebSocketMask(uint8_t* data, int64_t len, uint32_t maskingKey, int64_t phase);
+
+#endif